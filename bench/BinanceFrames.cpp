@@ -0,0 +1,23 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+#include <array>
+#include <string>
+
+/**
+ * Frames recorded from the binance spot and futures streams for btcusdt, replayed by the callback benchmarks.
+ */
+
+const std::array<std::string, 4> binance_spot_frames = {
+    R"({"e":"aggTrade","E":1750154523102,"s":"BTCUSDT","a":2731453262,"p":"106312.01000000","q":"0.00094000","f":4996350412,"l":4996350412,"T":1750154523101,"m":false,"M":true})",
+    R"({"e":"aggTrade","E":1750154523118,"s":"BTCUSDT","a":2731453263,"p":"106312.00000000","q":"0.00005000","f":4996350413,"l":4996350413,"T":1750154523117,"m":true,"M":true})",
+    R"({"e":"aggTrade","E":1750154523140,"s":"BTCUSDT","a":2731453264,"p":"106312.01000000","q":"0.01310000","f":4996350414,"l":4996350418,"T":1750154523139,"m":false,"M":true})",
+    R"({"e":"aggTrade","E":1750154523201,"s":"BTCUSDT","a":2731453265,"p":"106311.99000000","q":"0.00471000","f":4996350419,"l":4996350420,"T":1750154523200,"m":true,"M":true})",
+};
+
+const std::array<std::string, 4> binance_futures_frames = {
+    R"({"e":"aggTrade","E":1750154523095,"a":2686520371,"s":"BTCUSDT","p":"106264.10","q":"0.014","f":6386212240,"l":6386212240,"T":1750154522942,"m":false})",
+    R"({"e":"markPriceUpdate","E":1750154524000,"s":"BTCUSDT","p":"106262.50000000","P":"106289.18241290","i":"106316.31826087","r":"0.00004923","T":1750176000000})",
+    R"({"e":"aggTrade","E":1750154523162,"a":2686520372,"s":"BTCUSDT","p":"106264.00","q":"0.352","f":6386212241,"l":6386212246,"T":1750154523010,"m":true})",
+    R"({"e":"aggTrade","E":1750154523231,"a":2686520373,"s":"BTCUSDT","p":"106264.10","q":"0.002","f":6386212247,"l":6386212247,"T":1750154523079,"m":false})",
+};
@@ -0,0 +1,40 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+/**
+ * Replays recorded frames through the feed callbacks, json parse to queued TickData.
+ * The queue is drained every iteration so it never overflows.
+ */
+
+static void BM_BinanceSpotCallback(benchmark::State& state) {
+    TickQueue queue("bench_spot", 1024, DROP_NEWEST);
+    const auto callback = binance_callback_spot(queue, 0);
+
+    TickData tick;
+    size_t i = 0;
+    for (auto _ : state) {
+        callback(binance_spot_frames[i++ % binance_spot_frames.size()], 0);
+        queue.pop(tick);
+        benchmark::DoNotOptimize(tick);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinanceSpotCallback);
+
+static void BM_BinanceFuturesCallback(benchmark::State& state) {
+    TickQueue queue("bench_perp", 1024, DROP_NEWEST);
+    auto funding = std::make_shared<funding_map>();
+    funding->emplace("BTCUSDT", std::make_shared<std::atomic<double>>(-1.0));
+    const auto callback = binance_callback_futures(queue, funding, 0);
+
+    TickData tick;
+    size_t i = 0;
+    for (auto _ : state) {
+        callback(binance_futures_frames[i++ % binance_futures_frames.size()], 0);
+        queue.pop(tick);
+        benchmark::DoNotOptimize(tick);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinanceFuturesCallback);
@@ -0,0 +1,25 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+static TickData make_bench_tick(const bool perp) {
+    TickData tick;
+    std::strncpy(tick.venue, VenueToString(BINANCE), sizeof(tick.venue) - 1);
+    std::strncpy(tick.symbol, "BTCUSDT", sizeof(tick.symbol) - 1);
+    std::strncpy(tick.type, InstrumentTypeToString(perp ? PERP : SPOT), sizeof(tick.type) - 1);
+    tick.price = 106312.01;
+    tick.event_time_ms = 1750154523102;
+    tick.received_time_ns = 1750154523104512345;
+    tick.kernel_received_time_ns = 1750154523104301234;
+    if (perp) tick.funding_rate = 0.00004923;
+    return tick;
+}
+
+static void BM_TickToString(benchmark::State& state) {
+    const TickData tick = make_bench_tick(state.range(0));
+    for (auto _ : state) {
+        std::string out = tick_to_string(tick);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_TickToString)->ArgName("perp")->Arg(0)->Arg(1);
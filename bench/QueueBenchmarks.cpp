@@ -0,0 +1,77 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+/**
+ * One producer and one consumer pinned to separate cores, timed from release of both
+ * threads until the consumer has popped every tick. Skipped on hosts with a single core.
+ * TickQueue is run alongside the raw lockfree queue to show what the overflow accounting costs.
+ */
+
+constexpr int producer_core = 0;
+constexpr int consumer_core = 1;
+
+inline bool bench_push(boost::lockfree::queue<TickData> &queue, const TickData &tick) {return queue.bounded_push(tick);}
+inline bool bench_push(TickQueue &queue, const TickData &tick) {return queue.push(tick);}
+
+template<class Queue>
+double transfer_seconds(Queue &queue, const size_t count) {
+    std::atomic<bool> go{false};
+
+    std::thread consumer([&]() {
+        while (!go.load(std::memory_order_acquire)) {}
+        TickData tick;
+        size_t received = 0;
+        while (received < count) {
+            if (queue.pop(tick)) ++received;
+        }
+    });
+
+    std::thread producer([&]() {
+        while (!go.load(std::memory_order_acquire)) {}
+        TickData tick;
+        std::strncpy(tick.symbol, "BTCUSDT", sizeof(tick.symbol) - 1);
+        for (size_t i = 0; i < count; ++i) {
+            tick.event_time_ms = static_cast<int64_t>(i);
+            while (!bench_push(queue, tick)) {}
+        }
+    });
+
+    set_affinity(producer, producer_core);
+    set_affinity(consumer, consumer_core);
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    producer.join();
+    consumer.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void BM_LockfreeQueueTransfer(benchmark::State& state) {
+    if (std::thread::hardware_concurrency() < 2) {
+        state.SkipWithError("transfer needs at least 2 cores");
+        return;
+    }
+    boost::lockfree::queue<TickData> queue(1024);
+    const auto count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.SetIterationTime(transfer_seconds(queue, count));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LockfreeQueueTransfer)->Arg(1 << 16)->UseManualTime();
+
+static void BM_TickQueueTransfer(benchmark::State& state) {
+    if (std::thread::hardware_concurrency() < 2) {
+        state.SkipWithError("transfer needs at least 2 cores");
+        return;
+    }
+    // DROP_NEWEST so a full queue spins in the producer exactly like bounded_push above.
+    TickQueue queue("bench", 1024, DROP_NEWEST);
+    const auto count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        state.SetIterationTime(transfer_seconds(queue, count));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TickQueueTransfer)->Arg(1 << 16)->UseManualTime();
@@ -0,0 +1,27 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+/**
+ * spin_wait accuracy, reports how far past the target each wait returned.
+ */
+
+static void BM_SpinWait(benchmark::State& state) {
+    const std::chrono::nanoseconds target(state.range(0));
+    double total_overshoot_ns = 0;
+    double max_overshoot_ns = 0;
+
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        spin_wait(target);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        const double overshoot_ns = std::chrono::duration<double, std::nano>(elapsed - target).count();
+        total_overshoot_ns += overshoot_ns;
+        max_overshoot_ns = std::max(max_overshoot_ns, overshoot_ns);
+    }
+
+    state.counters["overshoot_ns"] = benchmark::Counter(total_overshoot_ns, benchmark::Counter::kAvgIterations);
+    state.counters["max_overshoot_ns"] = max_overshoot_ns;
+}
+BENCHMARK(BM_SpinWait)->Arg(1'000)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
@@ -0,0 +1,74 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+/**
+ * Seqlock write / read cost, range(0) = 1 runs a thread hammering the other side. The contender is
+ * pinned off the measured core (see main.cpp), contended runs are skipped on one core.
+ */
+
+constexpr int contender_core = 1;
+
+static void BM_TickDataBufferRead(benchmark::State& state) {
+    TickDataBuffer buffer;
+    std::atomic<bool> running{true};
+
+    if (state.range(0) && std::thread::hardware_concurrency() < 2) {
+        state.SkipWithError("contended run needs at least 2 cores");
+        return;
+    }
+
+    std::thread writer;
+    if (state.range(0)) {
+        writer = std::thread([&]() {
+            TickData tick;
+            while (running.load(std::memory_order_relaxed)) {
+                ++tick.event_time_ms;
+                buffer.write(tick);
+            }
+        });
+        set_affinity(writer, contender_core);
+    }
+
+    TickData out;
+    for (auto _ : state) {
+        buffer.read(out);
+        benchmark::DoNotOptimize(out);
+    }
+
+    running = false;
+    if (writer.joinable()) writer.join();
+}
+BENCHMARK(BM_TickDataBufferRead)->ArgName("contended")->Arg(0)->Arg(1);
+
+static void BM_TickDataBufferWrite(benchmark::State& state) {
+    TickDataBuffer buffer;
+    std::atomic<bool> running{true};
+
+    if (state.range(0) && std::thread::hardware_concurrency() < 2) {
+        state.SkipWithError("contended run needs at least 2 cores");
+        return;
+    }
+
+    std::thread reader;
+    if (state.range(0)) {
+        reader = std::thread([&]() {
+            TickData out;
+            while (running.load(std::memory_order_relaxed)) {
+                buffer.read(out);
+                benchmark::DoNotOptimize(out);
+            }
+        });
+        set_affinity(reader, contender_core);
+    }
+
+    TickData tick;
+    for (auto _ : state) {
+        ++tick.event_time_ms;
+        buffer.write(tick);
+    }
+
+    running = false;
+    if (reader.joinable()) reader.join();
+}
+BENCHMARK(BM_TickDataBufferWrite)->ArgName("contended")->Arg(0)->Arg(1);
@@ -0,0 +1,29 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <benchmark/benchmark.h>
+#include "../src/feeds/MarketDataFeedCallbacks.cpp"
+#include "../src/utils/Concurrency.cpp"
+// the runner thread is pinned once for the whole run, so results do not depend on filter or order.
+constexpr int measured_core = 0;
+
+#include "BinanceFrames.cpp"
+#include "CallbackBenchmarks.cpp"
+#include "QueueBenchmarks.cpp"
+#include "TickDataBufferBenchmarks.cpp"
+#include "FormattingBenchmarks.cpp"
+#include "SpinWaitBenchmarks.cpp"
+
+int main(int argc, char** argv) {
+    set_current_thread_affinity(measured_core);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
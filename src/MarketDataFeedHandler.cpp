@@ -2,11 +2,11 @@
 // Created by Yeo Shu Heng on 17/6/25.
 //
 #include <spdlog/spdlog.h>
-#include "boost/lockfree/queue.hpp"
 #include <iostream>
+#include <optional>
 #include "feeds/MarketDataFeeds.cpp"
 #include "utils/Concurrency.cpp"
-#include "feeds/tick/TickDataBuffer.cpp"
+#include "publisher/MulticastPublisher.cpp"
 
 class MarketDataFeedHandler {
 
@@ -17,14 +17,22 @@ class MarketDataFeedHandler {
     net::io_context& ioc;
     ssl::context& soc;
 
-    boost::lockfree::queue<TickData> &spot_tick_queue;
-    boost::lockfree::queue<TickData> &perp_tick_queue;
+    TickQueue &spot_tick_queue;
+    TickQueue &perp_tick_queue;
 
     TickDataBuffer spot_buffer;
     TickDataBuffer perp_buffer;
 
+    // one publisher per producing thread, each is its own sequenced stream.
+    std::unique_ptr<MulticastPublisher> spot_publisher;
+    std::unique_ptr<MulticastPublisher> perp_publisher;
+    std::unique_ptr<MulticastPublisher> snapshot_publisher;
+
     std::atomic<bool> is_running{false};
 
+    static constexpr int64_t stats_interval_ms = 5000;
+    int64_t last_stats_time_ms = 0;
+
     std::atomic<int64_t> last_snapshot_time_ns{0};
     std::atomic<int64_t> total_jitter_ns{0};
     std::atomic<size_t> jitter_count{0};
@@ -43,16 +51,10 @@ class MarketDataFeedHandler {
         }
 
         if (!data_buffer_ptr) return;
-        TickDataBuffer& data_buffer = *data_buffer_ptr;
-
-        const uint64_t old_version = data_buffer.version.load(std::memory_order_acquire);
-        const uint64_t new_version = old_version + 1;
-        const int write_idx = new_version % 2;
-        data_buffer.data_buffer[write_idx] = std::move(tick);
-        data_buffer.version.store(new_version, std::memory_order_release);
+        data_buffer_ptr->write(tick);
     };
 
-    void poll_ticker_queue(boost::lockfree::queue<TickData>& queue) {
+    void poll_ticker_queue(TickQueue& queue, MulticastPublisher* publisher) {
         TickData tick;
 
         // batch poll to reduce contention.
@@ -61,19 +63,40 @@ class MarketDataFeedHandler {
         batch.reserve(batch_size);
 
         while (is_running.load()) {
+            bool drained = true;
             while (queue.pop(tick)) {
                 batch.push_back(std::move(tick));
-                if (batch.size() == batch_size) break;
+                if (batch.size() == batch_size) {
+                    drained = false;
+                    break;
+                }
             }
 
             for (const auto& t : batch) {
                 process_tick(t);
+                if (publisher) publisher->publish(t, TICK_UPDATE);
             }
             batch.clear();
+
+            // only pay for the send once the queue is empty, bursts go out as full datagrams.
+            if (publisher && drained) publisher->flush();
         }
         spdlog::info("shutting down feed polling");
     }
 
+    static void log_queue_stats(const TickQueue &queue) {
+        const auto stats = queue.get_stats();
+        spdlog::info("Queue [{}] policy={} pushed={} popped={} dropped={} conflated={} high_water_mark={}",
+            queue.get_name(), OverflowPolicyToString(queue.get_policy()),
+            stats.pushed, stats.popped, stats.dropped, stats.conflated, stats.high_water_mark);
+    }
+
+    static void log_publisher_stats(const MulticastPublisher *publisher) {
+        if (!publisher) return;
+        spdlog::info("Multicast stream [{}] session={} dropped_datagrams={}",
+            publisher->get_stream_id(), publisher->get_session_id(), publisher->get_dropped_datagrams());
+    }
+
     /**
     * Snapshot processing related code.
     */
@@ -103,38 +126,49 @@ class MarketDataFeedHandler {
         }
 
         TickData spot_snapshot;
-        read_snapshot(spot_buffer, spot_snapshot);
+        spot_buffer.read(spot_snapshot);
 
         TickData perp_snapshot;
-        read_snapshot(perp_buffer, perp_snapshot);
+        perp_buffer.read(perp_snapshot);
 
         std::cout << "LATEST SNAPSHOT" << "\n";
         std::cout << tick_to_string(spot_snapshot) << "\n";
         std::cout << tick_to_string(perp_snapshot) << "\n";
         std::flush(std::cout);
-    }
-}
 
+        if (snapshot_publisher) {
+            snapshot_publisher->publish(spot_snapshot, SNAPSHOT_UPDATE);
+            snapshot_publisher->publish(perp_snapshot, SNAPSHOT_UPDATE);
+            snapshot_publisher->flush();
+        }
 
-    void read_snapshot(const TickDataBuffer& buffer, TickData& out_tick) {
-        const TickData* ptr = nullptr;
-        uint64_t v0, v1;
-        do {
-            v0 = buffer.version.load(std::memory_order_acquire);
-            const int read_idx = v0 % 2;
-            out_tick = buffer.data_buffer[read_idx];
-            v1 = buffer.version.load(std::memory_order_acquire);
-        } while (v0 != v1);
+        if (now_ms - last_stats_time_ms >= stats_interval_ms) {
+            log_queue_stats(spot_tick_queue);
+            log_queue_stats(perp_tick_queue);
+            log_publisher_stats(spot_publisher.get());
+            log_publisher_stats(perp_publisher.get());
+            log_publisher_stats(snapshot_publisher.get());
+            last_stats_time_ms = now_ms;
+        }
     }
+}
+
 
 public:
     MarketDataFeedHandler(const std::string &symbol,
         const int snapshot_frequency_ms,
         net::io_context& ioc,
         ssl::context& soc,
-        boost::lockfree::queue<TickData> &spot_tick_queue,
-         boost::lockfree::queue<TickData> &perp_tick_queue)
-    : symbol(symbol), snapshot_frequency_ms(snapshot_frequency_ms), ioc(ioc), soc(soc), spot_tick_queue(spot_tick_queue), perp_tick_queue(perp_tick_queue) {}
+        TickQueue &spot_tick_queue,
+         TickQueue &perp_tick_queue,
+        const std::optional<MulticastConfig> &multicast_config = std::nullopt)
+    : symbol(symbol), snapshot_frequency_ms(snapshot_frequency_ms), ioc(ioc), soc(soc), spot_tick_queue(spot_tick_queue), perp_tick_queue(perp_tick_queue) {
+        if (multicast_config) {
+            spot_publisher = std::make_unique<MulticastPublisher>(*multicast_config, 1);
+            perp_publisher = std::make_unique<MulticastPublisher>(*multicast_config, 2);
+            snapshot_publisher = std::make_unique<MulticastPublisher>(*multicast_config, 3);
+        }
+    }
 
     ~MarketDataFeedHandler() {
         kill_feeds();
@@ -146,8 +180,8 @@ public:
         MarketDataFeeds::start_feeds(symbol, ioc, soc, spot_tick_queue, perp_tick_queue);
 
         std::thread io_thread([this]() { ioc.run();});
-        std::thread spot_consumer_thread([this]() { poll_ticker_queue(spot_tick_queue); });
-        std::thread perp_consumer_thread([this]() { poll_ticker_queue(perp_tick_queue); });
+        std::thread spot_consumer_thread([this]() { poll_ticker_queue(spot_tick_queue, spot_publisher.get()); });
+        std::thread perp_consumer_thread([this]() { poll_ticker_queue(perp_tick_queue, perp_publisher.get()); });
 
         std::thread snapshot_thread([this]() {process_snapshot();});
 
@@ -11,18 +11,19 @@ class MarketDataFeed : public WebSocket {
 
     std::string feed_name;
 
-    std::function<void(const std::string&)> callback;
+    std::function<void(const std::string&, int64_t)> callback;
 
 protected:
-    void handle_response(const std::string &msg) override {
-        callback(msg);
+    void handle_response(const std::string &msg, const int64_t kernel_received_time_ns) override {
+        callback(msg, kernel_received_time_ns);
     }
 
 public:
     MarketDataFeed(const std::string &feed_name, boost::asio::io_context &ioc, ssl::context &soc,
         const std::string &host, const std::string &port,
-        const std::string &target, const std::function<void(const std::string&)> &callback)
-        : WebSocket(ioc, soc, host, port, target), feed_name(feed_name), callback(callback) {}
+        const std::string &target, const std::function<void(const std::string&, int64_t)> &callback,
+        const SocketOptions &socket_options = {})
+        : WebSocket(ioc, soc, host, port, target, socket_options), feed_name(feed_name), callback(callback) {}
 
     std::string to_string() const override {
         return std::format("host = {} port = {} target = {}", get_host(), get_port(), get_target());
@@ -4,9 +4,9 @@
 
 #include <string>
 #include <spdlog/spdlog.h>
-#include "boost/lockfree/queue.hpp"
 #include "nlohmann/json.hpp"
 #include "tick/TickData.cpp"
+#include "tick/TickQueue.cpp"
 #include "tick/Venue.cpp"
 #include "tick/InstrumentType.cpp"
 #include "../utils/StringModifications.cpp"
@@ -14,11 +14,11 @@
 typedef std::unordered_map<std::string, std::shared_ptr<std::atomic<double>>> funding_map;
 using json = nlohmann::json;
 
-std::function<void(const std::string&)> binance_callback_spot(
-    boost::lockfree::queue<TickData> &tick_queue,
+std::function<void(const std::string&, int64_t)> binance_callback_spot(
+    TickQueue &tick_queue,
     int64_t offset_t) {
 
-    return [&tick_queue, offset_t](const std::string& resp) {
+    return [&tick_queue, offset_t](const std::string& resp, const int64_t kernel_received_ts_ns) {
         const auto received_ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
             std::chrono::system_clock::now().time_since_epoch()
         ).count();
@@ -49,21 +49,21 @@ std::function<void(const std::string&)> binance_callback_spot(
         tick.price = price;
         tick.event_time_ms = event_time;
         tick.received_time_ns = received_ts_ns;
+        tick.kernel_received_time_ns = kernel_received_ts_ns;
         tick.funding_rate = NAN;
         tick.next_funding_time_ms = -1;
 
-        if (!tick_queue.push(tick)) {
-            spdlog::warn("tick queue full, dropped SPOT message {}", received_ts_ns);
-        }
+        // overflow is counted by the queue, logging here would slow the io thread when it is already behind.
+        tick_queue.push(tick);
     };
 }
 
-std::function<void(const std::string&)> binance_callback_futures(
-    boost::lockfree::queue<TickData> &tick_queue,
+std::function<void(const std::string&, int64_t)> binance_callback_futures(
+    TickQueue &tick_queue,
     std::shared_ptr<funding_map> funding_map,
     int64_t offset_t) {
 
-    return [&tick_queue, funding_map, offset_t](const std::string& resp) {
+    return [&tick_queue, funding_map, offset_t](const std::string& resp, const int64_t kernel_received_ts_ns) {
         const auto received_ts_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
             std::chrono::system_clock::now().time_since_epoch()
         ).count();
@@ -103,13 +103,12 @@ std::function<void(const std::string&)> binance_callback_futures(
             tick.price = price;
             tick.event_time_ms = event_time;
             tick.received_time_ns = received_ts_ns;
+            tick.kernel_received_time_ns = kernel_received_ts_ns;
 
             tick.funding_rate = (*funding_map)[to_upper(symbol)]->load();
             tick.next_funding_time_ms = -1;
 
-            if (!tick_queue.push(tick)) {
-                spdlog::warn("tick queue full, dropped PERP message {}", received_ts_ns);
-            }
+            tick_queue.push(tick);
 
         };
     };
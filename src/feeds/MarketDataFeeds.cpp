@@ -5,7 +5,6 @@
 
 #include "MarketDataFeed.cpp"
 #include "MarketDataFeedCallbacks.cpp"
-#include "boost/lockfree/queue.hpp"
 #include "SynchroniseTime.cpp"
 
 class MarketDataFeeds {
@@ -16,14 +15,21 @@ public:
         const std::string& symbol,
         net::io_context& ioc,
         ssl::context& soc,
-        boost::lockfree::queue<TickData> &spot_queue,
-        boost::lockfree::queue<TickData> &perp_queue) {
+        TickQueue &spot_queue,
+        TickQueue &perp_queue) {
 
         auto binance_funding_map = std::make_shared<funding_map>();
         binance_funding_map->emplace(to_upper(symbol), std::make_shared<std::atomic<double>>(-1.0));
 
         const int64_t binance_offset_ms = compute_time_offset();
 
+        // futures carries aggTrade + markPrice on one connection, give it the larger buffer.
+        SocketOptions binance_futures_socket_options;
+        binance_futures_socket_options.receive_buffer_bytes = 4 << 20;
+
+        SocketOptions binance_spot_socket_options;
+        binance_spot_socket_options.receive_buffer_bytes = 1 << 20;
+
         const auto binance_futures_data_feed = std::make_shared<MarketDataFeed>(
            "binance_futures_feed",
            ioc, soc,
@@ -31,7 +37,8 @@ public:
            "443",
            "/ws",
            binance_callback_futures(perp_queue,
-               binance_funding_map, binance_offset_ms));
+               binance_funding_map, binance_offset_ms),
+           binance_futures_socket_options);
 
         binance_futures_data_feed->connect();
 
@@ -41,7 +48,8 @@ public:
             "stream.binance.com",
             "9443",
             "/ws",
-            binance_callback_spot(spot_queue, binance_offset_ms));
+            binance_callback_spot(spot_queue, binance_offset_ms),
+            binance_spot_socket_options);
 
         binance_spot_data_feed->connect();
 
@@ -0,0 +1,31 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+/**
+ * Per feed kernel socket tuning, applied when the feed's socket is opened.
+ * Options the platform does not support are skipped with a warning.
+ */
+struct SocketOptions {
+
+    bool tcp_nodelay = true;
+
+    // SO_RCVBUF in bytes, 0 keeps the kernel default (and its autotuning).
+    int receive_buffer_bytes = 0;
+
+    /**
+     * SO_BUSY_POLL in microseconds, 0 disables. raising it above net.core.busy_read needs CAP_NET_ADMIN.
+     *
+     * Feeds read non-blocking after the io_context's epoll wait, so the per-socket value alone only
+     * buys one poll pass per read. Busy polling inside epoll_wait needs the net.core.busy_poll sysctl
+     * set (e.g. 50), and SO_PREFER_BUSY_POLL only has an effect on top of that.
+     */
+    int busy_poll_us = 0;
+    bool prefer_busy_poll = false;
+
+    // the kernel clears TCP_QUICKACK on its own, so it is re-armed after every read.
+    bool quickack = true;
+
+    // SO_TIMESTAMPING software receive timestamps, surfaced as TickData::kernel_received_time_ns.
+    bool receive_timestamps = true;
+};
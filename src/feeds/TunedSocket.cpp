@@ -0,0 +1,268 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+#include <array>
+#include <cerrno>
+#include <ctime>
+#include <fstream>
+
+#include <boost/asio.hpp>
+#include <boost/beast/core.hpp>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <spdlog/spdlog.h>
+#ifdef __linux__
+#include <linux/net_tstamp.h>
+#endif
+
+#include "SocketOptions.cpp"
+
+namespace beast = boost::beast;
+namespace net = boost::asio;
+
+using tcp = net::ip::tcp;
+
+/**
+ * tcp::socket wrapper used as the lowest layer of the websocket stream.
+ *
+ * Reads go through recvmsg so the SO_TIMESTAMPING control message can be picked up, the
+ * timestamp of the latest read is kept in last_receive_time_ns (CLOCK_REALTIME, 0 if unavailable).
+ * Writes are forwarded to the wrapped socket untouched.
+ */
+class TunedSocket {
+
+    tcp::socket socket;
+    SocketOptions options;
+
+    int64_t last_receive_time_ns = 0;
+
+    static constexpr size_t max_iovecs = 16;
+
+    void set_option(const char* name, const int level, const int option, const int value) {
+        if (setsockopt(socket.native_handle(), level, option, &value, sizeof(value)) < 0) {
+            spdlog::warn("failed to set socket option {}={}, {}", name, value, std::strerror(errno));
+        }
+    }
+
+    void apply_options() {
+        if (options.tcp_nodelay) set_option("TCP_NODELAY", IPPROTO_TCP, TCP_NODELAY, 1);
+
+        if (options.receive_buffer_bytes > 0) {
+            set_option("SO_RCVBUF", SOL_SOCKET, SO_RCVBUF, options.receive_buffer_bytes);
+            int effective = 0;
+            socklen_t length = sizeof(effective);
+            getsockopt(socket.native_handle(), SOL_SOCKET, SO_RCVBUF, &effective, &length);
+            spdlog::info("socket receive buffer requested {} effective {}", options.receive_buffer_bytes, effective);
+        }
+
+#ifdef SO_BUSY_POLL
+        if (options.busy_poll_us > 0) {
+            set_option("SO_BUSY_POLL", SOL_SOCKET, SO_BUSY_POLL, options.busy_poll_us);
+            if (read_sysctl("/proc/sys/net/core/busy_poll") <= 0) {
+                spdlog::warn("SO_BUSY_POLL set but net.core.busy_poll is 0, epoll will not busy poll this socket");
+            }
+        }
+#else
+        if (options.busy_poll_us > 0) spdlog::warn("SO_BUSY_POLL not supported on this platform");
+#endif
+
+#ifdef SO_PREFER_BUSY_POLL
+        if (options.prefer_busy_poll) set_option("SO_PREFER_BUSY_POLL", SOL_SOCKET, SO_PREFER_BUSY_POLL, 1);
+#else
+        if (options.prefer_busy_poll) spdlog::warn("SO_PREFER_BUSY_POLL not supported on this platform");
+#endif
+
+        rearm_quickack();
+
+#ifdef __linux__
+        if (options.receive_timestamps) {
+            set_option("SO_TIMESTAMPING", SOL_SOCKET, SO_TIMESTAMPING,
+                SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE);
+        }
+#else
+        if (options.receive_timestamps) spdlog::warn("SO_TIMESTAMPING not supported on this platform");
+#endif
+    }
+
+    static int read_sysctl(const char* path) {
+        std::ifstream file(path);
+        int value = -1;
+        file >> value;
+        return value;
+    }
+
+    void rearm_quickack() {
+#ifdef TCP_QUICKACK
+        if (options.quickack) {
+            constexpr int enable = 1;
+            setsockopt(socket.native_handle(), IPPROTO_TCP, TCP_QUICKACK, &enable, sizeof(enable));
+        }
+#endif
+    }
+
+    void read_timestamp(msghdr &msg) {
+#ifdef __linux__
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPING) {
+                // struct scm_timestamping, ts[0] holds the software timestamp.
+                timespec ts[3];
+                std::memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+                if (ts[0].tv_sec != 0 || ts[0].tv_nsec != 0) {
+                    last_receive_time_ns = ts[0].tv_sec * 1'000'000'000LL + ts[0].tv_nsec;
+                }
+            }
+        }
+#else
+        (void)msg;
+#endif
+    }
+
+    /**
+     * Non-blocking recvmsg into buffers, sets would_block when there is nothing to read.
+     */
+    template<class MutableBufferSequence>
+    std::size_t receive(const MutableBufferSequence &buffers, beast::error_code &ec) {
+        std::array<iovec, max_iovecs> iov;
+        size_t iov_count = 0;
+        for (auto it = net::buffer_sequence_begin(buffers);
+             it != net::buffer_sequence_end(buffers) && iov_count < max_iovecs; ++it) {
+            const net::mutable_buffer buffer(*it);
+            if (buffer.size() == 0) continue;
+            iov[iov_count++] = {buffer.data(), buffer.size()};
+        }
+
+        ec = {};
+        if (iov_count == 0) return 0;
+
+        alignas(cmsghdr) char control[CMSG_SPACE(3 * sizeof(timespec))];
+        msghdr msg{};
+        msg.msg_iov = iov.data();
+        msg.msg_iovlen = iov_count;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        const ssize_t rc = ::recvmsg(socket.native_handle(), &msg, MSG_DONTWAIT);
+        if (rc < 0) {
+            ec.assign(errno, beast::system_category());
+            return 0;
+        }
+        if (rc == 0) {
+            ec = net::error::eof;
+            return 0;
+        }
+
+        read_timestamp(msg);
+        rearm_quickack();
+        return rc;
+    }
+
+    template<class Handler, class MutableBufferSequence>
+    void async_wait_and_receive(Handler &&handler, const MutableBufferSequence &buffers) {
+        socket.async_wait(tcp::socket::wait_read,
+            [this, handler = std::forward<Handler>(handler), buffers](const beast::error_code &ec) mutable {
+                if (ec) return complete(std::move(handler), ec, 0);
+
+                beast::error_code read_ec;
+                const std::size_t bytes = receive(buffers, read_ec);
+                if (read_ec == net::error::would_block || read_ec == net::error::try_again) {
+                    return async_wait_and_receive(std::move(handler), buffers);
+                }
+                complete(std::move(handler), read_ec, bytes);
+            });
+    }
+
+    template<class Handler>
+    void complete(Handler &&handler, const beast::error_code &ec, const std::size_t bytes) {
+        auto executor = net::get_associated_executor(handler, socket.get_executor());
+        net::dispatch(executor, beast::bind_front_handler(std::forward<Handler>(handler), ec, bytes));
+    }
+
+public:
+    using executor_type = tcp::socket::executor_type;
+    using next_layer_type = tcp::socket;
+    using lowest_layer_type = tcp::socket::lowest_layer_type;
+
+    explicit TunedSocket(net::io_context &ioc) : socket(ioc) {}
+
+    void set_options(const SocketOptions &socket_options) {options = socket_options;}
+
+    /**
+     * Tries each endpoint in turn, options are applied after open so SO_RCVBUF is in
+     * place before the handshake negotiates the window scale.
+     */
+    void connect(const tcp::resolver::results_type &endpoints, beast::error_code &ec) {
+        ec = net::error::host_not_found;
+        for (const auto &entry : endpoints) {
+            beast::error_code close_ec;
+            socket.close(close_ec);
+
+            socket.open(entry.endpoint().protocol(), ec);
+            if (ec) continue;
+            apply_options();
+            socket.connect(entry.endpoint(), ec);
+            if (!ec) return;
+        }
+    }
+
+    [[nodiscard]] int64_t get_last_receive_time_ns() const {return last_receive_time_ns;}
+
+    executor_type get_executor() noexcept {return socket.get_executor();}
+    next_layer_type& next_layer() {return socket;}
+    const next_layer_type& next_layer() const {return socket;}
+    lowest_layer_type& lowest_layer() {return socket.lowest_layer();}
+    const lowest_layer_type& lowest_layer() const {return socket.lowest_layer();}
+
+    template<class MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence &buffers, beast::error_code &ec) {
+        while (true) {
+            const std::size_t bytes = receive(buffers, ec);
+            if (ec != net::error::would_block && ec != net::error::try_again) return bytes;
+            socket.wait(tcp::socket::wait_read, ec);
+            if (ec) return 0;
+        }
+    }
+
+    template<class MutableBufferSequence>
+    std::size_t read_some(const MutableBufferSequence &buffers) {
+        beast::error_code ec;
+        const std::size_t bytes = read_some(buffers, ec);
+        if (ec) throw beast::system_error(ec);
+        return bytes;
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence &buffers, beast::error_code &ec) {
+        return socket.write_some(buffers, ec);
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t write_some(const ConstBufferSequence &buffers) {
+        return socket.write_some(buffers);
+    }
+
+    /**
+     * Tries the read straight away and only waits on the reactor when the socket is drained,
+     * the handler is always posted, never invoked inline.
+     */
+    template<class MutableBufferSequence, class ReadHandler>
+    auto async_read_some(const MutableBufferSequence &buffers, ReadHandler &&handler) {
+        return net::async_initiate<ReadHandler, void(beast::error_code, std::size_t)>(
+            [this](auto &&init_handler, const MutableBufferSequence &init_buffers) {
+                beast::error_code ec;
+                const std::size_t bytes = receive(init_buffers, ec);
+                if (ec == net::error::would_block || ec == net::error::try_again) {
+                    return async_wait_and_receive(std::forward<decltype(init_handler)>(init_handler), init_buffers);
+                }
+                auto executor = net::get_associated_executor(init_handler, socket.get_executor());
+                net::post(executor, beast::bind_front_handler(
+                    std::forward<decltype(init_handler)>(init_handler), ec, bytes));
+            }, handler, buffers);
+    }
+
+    template<class ConstBufferSequence, class WriteHandler>
+    auto async_write_some(const ConstBufferSequence &buffers, WriteHandler &&handler) {
+        return socket.async_write_some(buffers, std::forward<WriteHandler>(handler));
+    }
+};
@@ -9,6 +9,7 @@
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/ssl.hpp>
 #include <spdlog/spdlog.h>
+#include "TunedSocket.cpp"
 
 namespace beast = boost::beast;
 namespace net = boost::asio;
@@ -17,7 +18,7 @@ namespace ssl = boost::asio::ssl;
 
 using tcp = net::ip::tcp;
 
-typedef websocket::stream<beast::ssl_stream<tcp::socket>> ws;
+typedef websocket::stream<beast::ssl_stream<TunedSocket>> ws;
 
 class WebSocket : public std::enable_shared_from_this<WebSocket> {
 
@@ -41,23 +42,31 @@ class WebSocket : public std::enable_shared_from_this<WebSocket> {
         socket.async_read(buffer,
             [self = shared_from_this()](const beast::error_code &ec, std::size_t bytes_transferred) {
                 if (ec) {return log_error("read", ec);}
-                self->handle_response(beast::buffers_to_string(self->buffer.data()));
+                self->handle_response(beast::buffers_to_string(self->buffer.data()),
+                    self->socket.next_layer().next_layer().get_last_receive_time_ns());
                 self->buffer.consume(bytes_transferred);
                 self->read();
             });
     }
 
 protected:
-    virtual void handle_response(const std::string &msg) {
+    /**
+     * kernel_received_time_ns is the SO_TIMESTAMPING software receive timestamp of the latest
+     * segment read off the socket when the frame completed, 0 if unavailable.
+     */
+    virtual void handle_response(const std::string &msg, [[maybe_unused]] int64_t kernel_received_time_ns) {
         spdlog::info(msg);
     }
 
     virtual ~WebSocket() = default;
 
 public:
-    WebSocket(boost::asio::io_context &ioc, ssl::context &soc, const std::string &host, const std::string &port, const std::string &target)
+    WebSocket(boost::asio::io_context &ioc, ssl::context &soc, const std::string &host, const std::string &port, const std::string &target,
+        const SocketOptions &socket_options = {})
         : host(host), port(port), target(target),
-        socket(ioc, soc), ioc(ioc), soc(soc), resolver(ioc) {}
+        socket(ioc, soc), ioc(ioc), soc(soc), resolver(ioc) {
+        socket.next_layer().next_layer().set_options(socket_options);
+    }
 
     void connect() {
         beast::error_code ec;
@@ -66,7 +75,7 @@ public:
             log_error("resolve", ec);
             throw beast::system_error(ec);
         }
-        net::connect(socket.next_layer().next_layer(), results, ec);
+        socket.next_layer().next_layer().connect(results, ec);
         if (ec) {
             log_error("connect", ec);
             throw beast::system_error(ec);
@@ -0,0 +1,15 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+enum OverflowPolicy {
+    DROP_NEWEST, DROP_OLDEST, CONFLATE
+};
+
+const char* OverflowPolicyToString(const OverflowPolicy policy) {
+    switch(policy) {
+        case DROP_NEWEST: return "DROP_NEWEST";
+        case DROP_OLDEST: return "DROP_OLDEST";
+        case CONFLATE: return "CONFLATE";
+        default: return "UNKNOWN";
+    }
+}
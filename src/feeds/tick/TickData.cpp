@@ -15,6 +15,9 @@ struct TickData {
     int64_t event_time_ms;
     int64_t received_time_ns;
 
+    // SO_TIMESTAMPING software receive timestamp, 0 when the socket could not provide one.
+    int64_t kernel_received_time_ns;
+
     double funding_rate;
     int64_t next_funding_time_ms;
 
@@ -22,6 +25,7 @@ struct TickData {
         price(0.0),
         event_time_ms(0),
         received_time_ns(0),
+        kernel_received_time_ns(0),
         funding_rate(NAN),
         next_funding_time_ms(-1)
     {
@@ -41,6 +45,12 @@ std::string tick_to_string(const TickData& tick) {
         << ", EventTime(ms): " << tick.event_time_ms
         << ", ReceivedTime(ns): " << tick.received_time_ns;
 
+    if (tick.kernel_received_time_ns != 0) {
+        oss << ", KernelReceivedTime(ns): " << tick.kernel_received_time_ns;
+    } else {
+        oss << ", KernelReceivedTime(ns): N/A";
+    }
+
     if (!std::isnan(tick.funding_rate)) {
         oss << ", FundingRate: " << tick.funding_rate;
     } else {
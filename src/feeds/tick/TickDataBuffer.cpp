@@ -2,6 +2,7 @@
 // Created by Yeo Shu Heng on 23/6/25.
 //
 #include <array>
+#include <atomic>
 
 class TickDataBuffer {
 
@@ -13,4 +14,25 @@ public:
         data_buffer[0] = {};
         data_buffer[1] = {};
     }
-};
\ No newline at end of file
+
+    // single writer.
+    void write(const TickData &tick) {
+        const uint64_t old_version = version.load(std::memory_order_acquire);
+        const uint64_t new_version = old_version + 1;
+        const int write_idx = new_version % 2;
+        data_buffer[write_idx] = tick;
+        version.store(new_version, std::memory_order_release);
+    }
+
+    // returns the version that was read.
+    uint64_t read(TickData &out_tick) const {
+        uint64_t v0, v1;
+        do {
+            v0 = version.load(std::memory_order_acquire);
+            const int read_idx = v0 % 2;
+            out_tick = data_buffer[read_idx];
+            v1 = version.load(std::memory_order_acquire);
+        } while (v0 != v1);
+        return v0;
+    }
+};
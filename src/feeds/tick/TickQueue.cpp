@@ -0,0 +1,192 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+#include <array>
+#include <atomic>
+#include <string>
+#include "boost/lockfree/queue.hpp"
+#include "TickDataBuffer.cpp"
+#include "OverflowPolicy.cpp"
+
+/**
+ * Bounded single producer / single consumer tick queue with a configurable overflow policy.
+ *
+ * DROP_NEWEST: the incoming tick is discarded.
+ * DROP_OLDEST: the oldest queued tick is evicted to make room.
+ * CONFLATE:    the incoming tick goes into a per-symbol side slot holding only the latest tick,
+ *              which the consumer drains once the queue is empty. While a symbol's slot is
+ *              pending (written since the consumer last drained it), newer ticks for it keep going
+ *              to the slot so ordering is preserved.
+ *
+ * Overflow is only counted here, never logged, the counters are exported periodically by the handler.
+ */
+class TickQueue {
+
+public:
+    struct Stats {
+        uint64_t pushed;
+        uint64_t popped;
+        uint64_t dropped;
+        uint64_t conflated;
+        uint64_t high_water_mark;
+    };
+
+private:
+    static constexpr size_t max_conflation_slots = 16;
+
+    struct ConflationSlot {
+        char symbol[32]{};
+        TickDataBuffer buffer;
+        // buffer version the consumer last handed out, the slot is pending while they differ.
+        std::atomic<uint64_t> drained_version{0};
+    };
+
+    const std::string name;
+    const OverflowPolicy policy;
+
+    boost::lockfree::queue<TickData> queue;
+
+    std::array<ConflationSlot, max_conflation_slots> slots;
+    std::atomic<size_t> slot_count{0};
+
+    // producer side counters, popped is kept on its own line as the consumer writes it. Conflation slots
+    // are settled into pushed / conflated by the consumer when drained, so pending slot ticks are not counted yet.
+    alignas(64) std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> conflated{0};
+    std::atomic<uint64_t> high_water_mark{0};
+
+    // producer only, lets on_enqueued take evicted ticks out of the depth.
+    uint64_t evicted = 0;
+
+    alignas(64) std::atomic<uint64_t> popped{0};
+
+    ConflationSlot* find_slot(const char* symbol) {
+        const size_t count = slot_count.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            if (std::strncmp(slots[i].symbol, symbol, sizeof(slots[i].symbol)) == 0) return &slots[i];
+        }
+        return nullptr;
+    }
+
+    ConflationSlot* claim_slot(const char* symbol) {
+        const size_t count = slot_count.load(std::memory_order_relaxed);
+        if (count == max_conflation_slots) return nullptr;
+        std::memcpy(slots[count].symbol, symbol, strnlen(symbol, sizeof(slots[count].symbol) - 1));
+        slot_count.store(count + 1, std::memory_order_release);
+        return &slots[count];
+    }
+
+    static bool is_pending(const ConflationSlot &slot) {
+        return slot.buffer.version.load(std::memory_order_acquire) !=
+            slot.drained_version.load(std::memory_order_acquire);
+    }
+
+    void on_enqueued() {
+        const uint64_t total = pushed.fetch_add(1, std::memory_order_relaxed) + 1;
+        // a slot drain settling on the consumer can put popped one ahead of the total read here.
+        const uint64_t consumed = evicted + popped.load(std::memory_order_relaxed);
+        const uint64_t depth = total > consumed ? total - consumed : 0;
+        if (depth > high_water_mark.load(std::memory_order_relaxed)) {
+            high_water_mark.store(depth, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    TickQueue(const std::string &name, const size_t capacity, const OverflowPolicy policy)
+    : name(name), policy(policy), queue(capacity) {}
+
+    /**
+     * Called from the feed's io thread only. Returns false if the tick was dropped.
+     */
+    bool push(const TickData &tick) {
+        ConflationSlot* slot = nullptr;
+        if (policy == CONFLATE) {
+            slot = find_slot(tick.symbol);
+            if (slot && is_pending(*slot)) {
+                slot->buffer.write(tick);
+                return true;
+            }
+        }
+
+        // bounded_push never allocates, so capacity is what was reserved up front.
+        if (queue.bounded_push(tick)) {
+            on_enqueued();
+            return true;
+        }
+
+        switch (policy) {
+            case DROP_OLDEST: {
+                TickData oldest;
+                if (queue.pop(oldest)) {
+                    ++evicted;
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                // a failed pop means the consumer emptied the queue meanwhile, there is room either way.
+                if (queue.bounded_push(tick)) {
+                    on_enqueued();
+                    return true;
+                }
+                break;
+            }
+            case CONFLATE: {
+                if (!slot) slot = claim_slot(tick.symbol);
+                if (slot) {
+                    slot->buffer.write(tick);
+                    return true;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /**
+     * Called from the consumer thread only. Conflated ticks are handed out once the queue is empty.
+     */
+    bool pop(TickData &out_tick) {
+        if (queue.pop(out_tick)) {
+            popped.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        const size_t count = slot_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            if (is_pending(slots[i])) {
+                // anything queued before the slot was written is visible now and is older, it goes first.
+                if (queue.pop(out_tick)) {
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                // only the consumer writes drained_version, so whatever version is read is delivered exactly once.
+                const uint64_t last_drained = slots[i].drained_version.load(std::memory_order_relaxed);
+                const uint64_t version = slots[i].buffer.read(out_tick);
+                slots[i].drained_version.store(version, std::memory_order_release);
+
+                // one write per version, the one handed out counts as enqueued and the rest were conflated.
+                pushed.fetch_add(1, std::memory_order_relaxed);
+                conflated.fetch_add(version - last_drained - 1, std::memory_order_relaxed);
+                popped.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] Stats get_stats() const {
+        return {
+            pushed.load(std::memory_order_relaxed),
+            popped.load(std::memory_order_relaxed),
+            dropped.load(std::memory_order_relaxed),
+            conflated.load(std::memory_order_relaxed),
+            high_water_mark.load(std::memory_order_relaxed)
+        };
+    }
+
+    [[nodiscard]] std::string get_name() const {return name;}
+    [[nodiscard]] OverflowPolicy get_policy() const {return policy;}
+};
@@ -0,0 +1,42 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+#include <cmath>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <spdlog/spdlog.h>
+#include "spdlog/sinks/stdout_color_sinks-inl.h"
+#include "feeds/tick/TickData.cpp"
+#include "publisher/MulticastReceiver.cpp"
+
+std::atomic<bool> is_running{true};
+
+int main() {
+
+    const auto console = spdlog::stderr_color_mt("console");
+    console->set_level(spdlog::level::info);
+    spdlog::set_pattern("[%H:%M:%S] [%^%l%$] %v");
+
+    std::signal(SIGINT, [](int) { is_running = false; });
+
+    MulticastReceiver receiver(MulticastConfig{},
+        [](const uint64_t session_id, const uint16_t stream_id, const uint64_t sequence,
+           const WireMessageType message_type, const TickData &tick) {
+            std::cout << (message_type == SNAPSHOT_UPDATE ? "SNAPSHOT" : "TICK")
+                      << " session=" << session_id << " stream=" << stream_id << " seq=" << sequence << " "
+                      << tick_to_string(tick) << "\n";
+        },
+        [](const uint64_t session_id, const uint16_t stream_id, const uint64_t expected, const uint64_t received) {
+            spdlog::warn("gap on session {} stream {}: expected {} received {}", session_id, stream_id, expected, received);
+        });
+
+    receiver.run(is_running);
+
+    for (const auto& [key, stats] : receiver.get_stream_stats()) {
+        spdlog::info("session {} stream {}: records={} gaps={} missed={} duplicates={}",
+            key.first, key.second, stats.records, stats.gaps, stats.missed_records, stats.duplicate_records);
+    }
+}
@@ -0,0 +1,119 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+
+/**
+ * Loopback check for the feed socket path: a local TLS websocket server (self-signed cert) sends
+ * aggTrade frames to a MarketDataFeed running the binance spot callback with every SocketOptions
+ * knob enabled. Prints the average kernel -> callback latency and exits non-zero if any tick is
+ * missing or lacks its SO_TIMESTAMPING receive timestamp.
+ */
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include "spdlog/sinks/stdout_color_sinks-inl.h"
+#include "feeds/MarketDataFeed.cpp"
+#include "feeds/MarketDataFeedCallbacks.cpp"
+
+constexpr int frame_count = 100;
+
+void use_self_signed_certificate(ssl::context &ctx) {
+    EVP_PKEY* key = EVP_EC_gen("P-256");
+    X509* cert = X509_new();
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    X509_sign(cert, key, EVP_sha256());
+
+    SSL_CTX_use_certificate(ctx.native_handle(), cert);
+    SSL_CTX_use_PrivateKey(ctx.native_handle(), key);
+    X509_free(cert);
+    EVP_PKEY_free(key);
+}
+
+void serve_frames(tcp::acceptor &acceptor, ssl::context &server_soc) {
+    tcp::socket raw_socket(acceptor.get_executor());
+    acceptor.accept(raw_socket);
+
+    websocket::stream<beast::ssl_stream<tcp::socket>> server(std::move(raw_socket), server_soc);
+    server.next_layer().handshake(ssl::stream_base::server);
+    server.accept();
+
+    for (int i = 0; i < frame_count; ++i) {
+        const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        server.write(net::buffer(std::format(
+            R"({{"e":"aggTrade","E":{},"s":"BTCUSDT","a":{},"p":"106312.01000000","q":"0.00094000","T":{},"m":false,"M":true}})",
+            now_ms, i, now_ms)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // drop the connection rather than a close handshake, the client stops reading once it has every frame.
+    beast::error_code ec;
+    beast::get_lowest_layer(server).close(ec);
+}
+
+int main() {
+
+    const auto console = spdlog::stderr_color_mt("console");
+    console->set_level(spdlog::level::info);
+    spdlog::set_pattern("[%H:%M:%S] [%^%l%$] %v");
+
+    net::io_context server_ioc;
+    ssl::context server_soc(ssl::context::tlsv12_server);
+    use_self_signed_certificate(server_soc);
+
+    tcp::acceptor acceptor(server_ioc, {net::ip::make_address("127.0.0.1"), 0});
+    const auto port = std::to_string(acceptor.local_endpoint().port());
+    std::thread server_thread([&]() { serve_frames(acceptor, server_soc); });
+
+    net::io_context ioc;
+    ssl::context soc(ssl::context::tlsv12_client);
+
+    SocketOptions socket_options;
+    socket_options.receive_buffer_bytes = 1 << 20;
+    socket_options.busy_poll_us = 50;
+    socket_options.prefer_busy_poll = true;
+
+    TickQueue tick_queue("loopback", 1024, DROP_NEWEST);
+
+    const auto feed = std::make_shared<MarketDataFeed>(
+        "loopback_feed", ioc, soc, "localhost", port, "/",
+        binance_callback_spot(tick_queue, 0), socket_options);
+    feed->connect();
+
+    int received = 0;
+    int missing_timestamps = 0;
+    int64_t total_latency_ns = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    TickData tick;
+    while (received < frame_count && std::chrono::steady_clock::now() < deadline) {
+        ioc.run_one_for(std::chrono::milliseconds(100));
+        while (tick_queue.pop(tick)) {
+            ++received;
+            if (tick.kernel_received_time_ns == 0) {
+                ++missing_timestamps;
+                continue;
+            }
+            total_latency_ns += tick.received_time_ns - tick.kernel_received_time_ns;
+        }
+    }
+
+    ioc.stop();
+    server_thread.join();
+
+    const int timestamped = received - missing_timestamps;
+    spdlog::info("received={} timestamped={} avg kernel->callback latency (ns)={}",
+        received, timestamped, timestamped ? total_latency_ns / timestamped : 0);
+
+    return received == frame_count && missing_timestamps == 0 ? 0 : 1;
+}
@@ -19,12 +19,12 @@ int main() {
     soc.load_verify_file("/opt/homebrew/etc/openssl@3/cert.pem");
     soc.set_default_verify_paths();
 
-    boost::lockfree::queue<TickData> perp_tick_queue(1024);
-    boost::lockfree::queue<TickData> spot_tick_queue(1024);
+    TickQueue perp_tick_queue("binance_perp", 1024, CONFLATE);
+    TickQueue spot_tick_queue("binance_spot", 1024, CONFLATE);
 
 
     auto feed_handler = MarketDataFeedHandler(
-        "btcusdt", 500, ioc, soc, spot_tick_queue, perp_tick_queue);
+        "btcusdt", 500, ioc, soc, spot_tick_queue, perp_tick_queue, MulticastConfig{});
 
     feed_handler.start_feeds();
 }
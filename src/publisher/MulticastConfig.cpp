@@ -0,0 +1,23 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+#pragma once
+#include <cstdint>
+#include <string>
+
+struct MulticastConfig {
+
+    std::string group = "239.255.0.1";
+    uint16_t port = 30001;
+
+    // local interface used to send / join the group, "0.0.0.0" lets the kernel pick.
+    std::string interface_address = "0.0.0.0";
+
+    int ttl = 1;
+
+    // keep on so consumers on the same host (and loopback tests) see our datagrams.
+    bool loopback = true;
+
+    size_t records_per_datagram = 18;
+    size_t datagrams_per_send = 16;
+};
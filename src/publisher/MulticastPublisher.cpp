@@ -0,0 +1,194 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <system_error>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+#include "MulticastConfig.cpp"
+#include "WireFormat.cpp"
+
+/**
+ * Batches encoded ticks into datagrams and sends them to a multicast group.
+ * Not thread safe, each producing thread should own its own publisher (and stream_id).
+ */
+class MulticastPublisher {
+
+    int fd = -1;
+    sockaddr_in destination{};
+
+    const uint16_t stream_id;
+    const uint64_t session_id;
+    uint64_t next_sequence = 1;
+
+    const size_t records_per_datagram;
+    const size_t max_datagrams;
+
+    // records are staged contiguously, datagram i sends staged[i * records_per_datagram, ...).
+    std::vector<WireRecord> staged;
+    size_t staged_count = 0;
+    uint64_t staged_first_sequence = 1;
+
+    std::vector<WireHeader> headers;
+    std::vector<iovec> iovecs;
+#ifdef __linux__
+    std::vector<mmsghdr> messages;
+#else
+    std::vector<msghdr> messages;
+#endif
+
+    // read by the snapshot thread for stats, failures are never logged on the sending thread.
+    std::atomic<uint64_t> dropped_datagrams{0};
+
+    static void throw_errno(const std::string& stage) {
+        const std::error_code ec(errno, std::generic_category());
+        spdlog::error("multicast publisher error in stage {}, {}", stage, ec.message());
+        throw std::system_error(ec, stage);
+    }
+
+    // never blocks the consuming thread, a full send buffer fails with EAGAIN / ENOBUFS instead.
+    int send_batch(const size_t first, const size_t count) {
+#ifdef __linux__
+        return sendmmsg(fd, &messages[first], count, MSG_DONTWAIT);
+#else
+        for (size_t i = 0; i < count; ++i) {
+            if (sendmsg(fd, &messages[first + i], MSG_DONTWAIT) < 0) {
+                return i == 0 ? -1 : static_cast<int>(i);
+            }
+        }
+        return static_cast<int>(count);
+#endif
+    }
+
+public:
+    MulticastPublisher(const MulticastConfig &config, const uint16_t stream_id)
+    : stream_id(stream_id),
+      // publisher start time, distinct across restarts and (in practice) across processes.
+      session_id(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()),
+      records_per_datagram(std::clamp<size_t>(config.records_per_datagram, 1, MAX_RECORDS_PER_DATAGRAM)),
+      max_datagrams(std::max<size_t>(config.datagrams_per_send, 1)) {
+
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) throw_errno("socket");
+
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(config.port);
+        if (inet_pton(AF_INET, config.group.c_str(), &destination.sin_addr) != 1) {
+            close(fd);
+            errno = EINVAL;
+            throw_errno("group address");
+        }
+
+        in_addr interface{};
+        if (inet_pton(AF_INET, config.interface_address.c_str(), &interface) != 1 ||
+            setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) < 0) {
+            close(fd);
+            throw_errno("multicast interface");
+        }
+
+        const auto ttl = static_cast<unsigned char>(config.ttl);
+        const unsigned char loop = config.loopback ? 1 : 0;
+        if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0 ||
+            setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) < 0) {
+            close(fd);
+            throw_errno("multicast options");
+        }
+
+        staged.resize(records_per_datagram * max_datagrams);
+        headers.resize(max_datagrams);
+        iovecs.resize(max_datagrams * 2);
+        messages.resize(max_datagrams);
+
+        // headers and records are gathered straight from the staging buffers, only lengths change per send.
+        for (size_t i = 0; i < max_datagrams; ++i) {
+            iovecs[2 * i] = {&headers[i], sizeof(WireHeader)};
+            iovecs[2 * i + 1] = {&staged[i * records_per_datagram], 0};
+
+#ifdef __linux__
+            msghdr &hdr = messages[i].msg_hdr;
+#else
+            msghdr &hdr = messages[i];
+#endif
+            std::memset(&hdr, 0, sizeof(msghdr));
+            hdr.msg_name = &destination;
+            hdr.msg_namelen = sizeof(destination);
+            hdr.msg_iov = &iovecs[2 * i];
+            hdr.msg_iovlen = 2;
+        }
+
+        spdlog::info("multicast publisher [{}:{}] stream {} ready, {} records per datagram",
+            config.group, config.port, stream_id, records_per_datagram);
+    }
+
+    MulticastPublisher(const MulticastPublisher&) = delete;
+    MulticastPublisher& operator=(const MulticastPublisher&) = delete;
+
+    ~MulticastPublisher() {
+        flush();
+        if (fd >= 0) close(fd);
+    }
+
+    void publish(const TickData &tick, const WireMessageType message_type) {
+        if (staged_count == 0) staged_first_sequence = next_sequence;
+        encode_record(tick, message_type, staged[staged_count++]);
+        ++next_sequence;
+
+        if (staged_count == staged.size()) flush();
+    }
+
+    /**
+     * Sends everything staged, using one sendmmsg call for up to datagrams_per_send datagrams.
+     */
+    void flush() {
+        if (staged_count == 0) return;
+
+        const int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        const size_t datagram_count = (staged_count + records_per_datagram - 1) / records_per_datagram;
+        for (size_t i = 0; i < datagram_count; ++i) {
+            const size_t record_count = std::min(records_per_datagram, staged_count - i * records_per_datagram);
+
+            WireHeader &header = headers[i];
+            header.magic = WIRE_MAGIC;
+            header.version = WIRE_VERSION;
+            header.record_count = static_cast<uint8_t>(record_count);
+            header.stream_id = stream_id;
+            header.record_length = sizeof(WireRecord);
+            header.session_id = session_id;
+            header.first_sequence = staged_first_sequence + i * records_per_datagram;
+            header.sent_time_ns = now_ns;
+
+            iovecs[2 * i + 1].iov_len = record_count * sizeof(WireRecord);
+        }
+
+        size_t sent = 0;
+        while (sent < datagram_count) {
+            const int rc = send_batch(sent, datagram_count - sent);
+            if (rc < 0) {
+                if (errno == EINTR) continue;
+                // EAGAIN / ENOBUFS included, downstream sees the sequence gap, no point retrying stale data.
+                dropped_datagrams.fetch_add(datagram_count - sent, std::memory_order_relaxed);
+                break;
+            }
+            sent += rc;
+        }
+
+        staged_count = 0;
+    }
+
+    [[nodiscard]] uint16_t get_stream_id() const {return stream_id;}
+    [[nodiscard]] uint64_t get_next_sequence() const {return next_sequence;}
+    [[nodiscard]] uint64_t get_session_id() const {return session_id;}
+    [[nodiscard]] uint64_t get_dropped_datagrams() const {return dropped_datagrams.load(std::memory_order_relaxed);}
+};
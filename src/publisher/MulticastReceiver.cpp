@@ -0,0 +1,216 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <system_error>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <spdlog/spdlog.h>
+
+#include "MulticastConfig.cpp"
+#include "WireFormat.cpp"
+
+/**
+ * Joins a multicast group published by MulticastPublisher, decodes records and tracks
+ * sequence gaps per (session_id, stream_id). session_id is the publisher's start time, a session
+ * that started after this receiver joined is expected from sequence 1, an older one is joined late
+ * and tracked from whatever sequence arrives first.
+ */
+class MulticastReceiver {
+
+public:
+    typedef std::function<void(uint64_t session_id, uint16_t stream_id, uint64_t sequence,
+        WireMessageType, const TickData&)> record_callback;
+    typedef std::function<void(uint64_t session_id, uint16_t stream_id,
+        uint64_t expected_sequence, uint64_t received_sequence)> gap_callback;
+
+    typedef std::pair<uint64_t, uint16_t> stream_key;
+
+    struct StreamStats {
+        uint64_t expected_sequence = 0;
+        uint64_t records = 0;
+        uint64_t gaps = 0;
+        uint64_t missed_records = 0;
+        uint64_t duplicate_records = 0;
+    };
+
+private:
+    static constexpr size_t batch_size = 32;
+
+    int fd = -1;
+
+    record_callback on_record;
+    gap_callback on_gap;
+
+    std::map<stream_key, StreamStats> streams;
+    uint64_t joined_at_ns = 0;
+    uint64_t malformed_datagrams = 0;
+
+    std::vector<std::array<char, MAX_DATAGRAM_SIZE>> buffers;
+    std::vector<iovec> iovecs;
+#ifdef __linux__
+    std::vector<mmsghdr> messages;
+#endif
+
+    static void throw_errno(const std::string& stage) {
+        const std::error_code ec(errno, std::generic_category());
+        spdlog::error("multicast receiver error in stage {}, {}", stage, ec.message());
+        throw std::system_error(ec, stage);
+    }
+
+    void handle_datagram(const char* data, const size_t length) {
+        WireHeader header;
+        if (length < sizeof(WireHeader)) {
+            ++malformed_datagrams;
+            return;
+        }
+        std::memcpy(&header, data, sizeof(WireHeader));
+
+        if (header.magic != WIRE_MAGIC || header.version != WIRE_VERSION ||
+            header.record_length != sizeof(WireRecord) ||
+            length < sizeof(WireHeader) + header.record_count * sizeof(WireRecord)) {
+            ++malformed_datagrams;
+            return;
+        }
+
+        const stream_key key{header.session_id, header.stream_id};
+        auto it = streams.find(key);
+        if (it == streams.end()) {
+            it = streams.emplace(key, StreamStats{}).first;
+            // a session already live when we joined is a late join, not a gap.
+            if (header.session_id >= joined_at_ns) {
+                spdlog::info("multicast stream {} started new session {}", header.stream_id, header.session_id);
+                it->second.expected_sequence = 1;
+            }
+        }
+
+        StreamStats &stream = it->second;
+        const uint64_t first = header.first_sequence;
+        const uint64_t end = first + header.record_count;
+
+        if (stream.expected_sequence != 0 && first > stream.expected_sequence) {
+            ++stream.gaps;
+            stream.missed_records += first - stream.expected_sequence;
+            if (on_gap) on_gap(header.session_id, header.stream_id, stream.expected_sequence, first);
+        }
+
+        const uint64_t start = std::max(first, stream.expected_sequence);
+        if (start > first) stream.duplicate_records += std::min(start, end) - first;
+
+        WireRecord record;
+        TickData tick;
+        for (uint64_t sequence = start; sequence < end; ++sequence) {
+            std::memcpy(&record, data + sizeof(WireHeader) + (sequence - first) * sizeof(WireRecord), sizeof(WireRecord));
+            decode_record(record, tick);
+            ++stream.records;
+            if (on_record) on_record(header.session_id, header.stream_id, sequence, static_cast<WireMessageType>(record.message_type), tick);
+        }
+
+        stream.expected_sequence = std::max(stream.expected_sequence, end);
+    }
+
+public:
+    MulticastReceiver(const MulticastConfig &config, record_callback on_record, gap_callback on_gap = nullptr)
+    : on_record(std::move(on_record)), on_gap(std::move(on_gap)) {
+
+        fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) throw_errno("socket");
+
+        // several consumers on one host share the group port.
+        constexpr int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#ifdef SO_REUSEPORT
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+#endif
+
+        // wake up periodically so run() can observe its stop flag.
+        timeval timeout{0, 100'000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        sockaddr_in local{};
+        local.sin_family = AF_INET;
+        local.sin_port = htons(config.port);
+        local.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+            close(fd);
+            throw_errno("bind");
+        }
+
+        ip_mreq membership{};
+        if (inet_pton(AF_INET, config.group.c_str(), &membership.imr_multiaddr) != 1 ||
+            inet_pton(AF_INET, config.interface_address.c_str(), &membership.imr_interface) != 1) {
+            close(fd);
+            errno = EINVAL;
+            throw_errno("group address");
+        }
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) < 0) {
+            close(fd);
+            throw_errno("join group");
+        }
+
+        buffers.resize(batch_size);
+        iovecs.resize(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            iovecs[i] = {buffers[i].data(), buffers[i].size()};
+        }
+#ifdef __linux__
+        messages.resize(batch_size);
+#endif
+
+        joined_at_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        spdlog::info("multicast receiver joined [{}:{}]", config.group, config.port);
+    }
+
+    MulticastReceiver(const MulticastReceiver&) = delete;
+    MulticastReceiver& operator=(const MulticastReceiver&) = delete;
+
+    ~MulticastReceiver() {
+        if (fd >= 0) close(fd);
+    }
+
+    /**
+     * Receives and dispatches one batch of datagrams, blocks for at most the socket timeout.
+     * Returns the number of datagrams handled.
+     */
+    size_t poll() {
+#ifdef __linux__
+        for (size_t i = 0; i < batch_size; ++i) {
+            std::memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        const int rc = recvmmsg(fd, messages.data(), batch_size, MSG_WAITFORONE, nullptr);
+        if (rc <= 0) return 0;
+        for (int i = 0; i < rc; ++i) {
+            handle_datagram(buffers[i].data(), messages[i].msg_len);
+        }
+        return rc;
+#else
+        const ssize_t rc = recv(fd, buffers[0].data(), buffers[0].size(), 0);
+        if (rc <= 0) return 0;
+        handle_datagram(buffers[0].data(), rc);
+        return 1;
+#endif
+    }
+
+    void run(const std::atomic<bool> &is_running) {
+        while (is_running.load(std::memory_order_relaxed)) {
+            poll();
+        }
+    }
+
+    [[nodiscard]] const std::map<stream_key, StreamStats>& get_stream_stats() const {return streams;}
+    [[nodiscard]] uint64_t get_malformed_datagrams() const {return malformed_datagrams;}
+};
@@ -0,0 +1,96 @@
+//
+// Created by Yeo Shu Heng on 19/10/26.
+//
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Fixed layout, little-endian binary encoding of TickData (SBE-style).
+ *
+ * Each datagram is a WireHeader followed by record_count WireRecords. Records carry no
+ * sequence of their own, record i of a datagram has sequence first_sequence + i.
+ * Sequences start at 1 and are per (session_id, stream_id), a publisher picks a new
+ * session_id every time it starts so receivers can tell restarts and publishers apart.
+ */
+
+static_assert(std::endian::native == std::endian::little, "wire format is little-endian");
+
+constexpr uint16_t WIRE_MAGIC = 0xFEED;
+constexpr uint8_t WIRE_VERSION = 3;
+
+// 1500 byte ethernet MTU - 20 byte IPv4 header - 8 byte UDP header.
+constexpr size_t MAX_DATAGRAM_SIZE = 1472;
+
+enum WireMessageType : uint8_t {
+    TICK_UPDATE = 1, SNAPSHOT_UPDATE = 2
+};
+
+#pragma pack(push, 1)
+struct WireHeader {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t record_count;
+    uint16_t stream_id;
+    uint16_t record_length;
+    uint64_t session_id;
+    uint64_t first_sequence;
+    int64_t sent_time_ns;
+};
+
+struct WireRecord {
+    uint8_t message_type;
+    uint8_t reserved[3];
+
+    // not null terminated when the field is full.
+    char venue[4];
+    char type[4];
+    char symbol[20];
+
+    double price;
+
+    int64_t event_time_ms;
+    int64_t received_time_ns;
+    int64_t kernel_received_time_ns;
+
+    double funding_rate;
+    int64_t next_funding_time_ms;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(WireHeader) == 32);
+static_assert(sizeof(WireRecord) == 80);
+
+constexpr size_t MAX_RECORDS_PER_DATAGRAM = (MAX_DATAGRAM_SIZE - sizeof(WireHeader)) / sizeof(WireRecord);
+
+inline void encode_record(const TickData &tick, const WireMessageType message_type, WireRecord &out) {
+    std::memset(&out, 0, sizeof(WireRecord));
+    out.message_type = message_type;
+
+    std::memcpy(out.venue, tick.venue, strnlen(tick.venue, sizeof(out.venue)));
+    std::memcpy(out.type, tick.type, strnlen(tick.type, sizeof(out.type)));
+    std::memcpy(out.symbol, tick.symbol, strnlen(tick.symbol, sizeof(out.symbol)));
+
+    out.price = tick.price;
+    out.event_time_ms = tick.event_time_ms;
+    out.received_time_ns = tick.received_time_ns;
+    out.kernel_received_time_ns = tick.kernel_received_time_ns;
+    out.funding_rate = tick.funding_rate;
+    out.next_funding_time_ms = tick.next_funding_time_ms;
+}
+
+inline void decode_record(const WireRecord &record, TickData &out) {
+    out = {};
+
+    std::memcpy(out.venue, record.venue, strnlen(record.venue, sizeof(record.venue)));
+    std::memcpy(out.type, record.type, strnlen(record.type, sizeof(record.type)));
+    std::memcpy(out.symbol, record.symbol, strnlen(record.symbol, sizeof(record.symbol)));
+
+    out.price = record.price;
+    out.event_time_ms = record.event_time_ms;
+    out.received_time_ns = record.received_time_ns;
+    out.kernel_received_time_ns = record.kernel_received_time_ns;
+    out.funding_rate = record.funding_rate;
+    out.next_funding_time_ms = record.next_funding_time_ms;
+}
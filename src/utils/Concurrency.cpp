@@ -3,11 +3,11 @@
 //
 
 #include <thread>
+#include <pthread.h>
 #ifdef __APPLE__
 #include <mach/mach.h>
 #include <mach/thread_policy.h>
 #elif __linux__
-#include <pthread.h>
 #include <sched.h>
 #endif
 
@@ -18,26 +18,31 @@ void spin_wait(std::chrono::nanoseconds target_duration) {
     }
 }
 
-void set_affinity(std::thread &to_pin, int core) {
+void set_native_affinity(std::thread::native_handle_type thread, int core) {
 #ifdef __APPLE__
     thread_affinity_policy policy;
     policy.affinity_tag = core;
-    const thread_port_t mach_thread = mach_thread_self();
-    thread_policy_set(mach_thread,
+    thread_policy_set(pthread_mach_thread_np(thread),
         THREAD_AFFINITY_POLICY,
         reinterpret_cast<thread_policy_t>(&policy),
         THREAD_AFFINITY_POLICY_COUNT);
-    mach_port_deallocate(mach_task_self(), mach_thread);
 #elif __linux__
     cpu_set_t cpuset;
     CPU_ZERO(&cpuset);
     CPU_SET(core, &cpuset);
-    pthread_t pthread_id = to_pin.native_handle();
-    int rc = pthread_setaffinity_np(pthread_id, sizeof(cpu_set_t), &cpuset);
+    int rc = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
     if (rc != 0) {
         perror("pthread_setaffinity_np");
     }
 #else
-    (void)to_pin; (void)core;
+    (void)thread; (void)core;
 #endif
 }
+
+void set_affinity(std::thread &to_pin, int core) {
+    set_native_affinity(to_pin.native_handle(), core);
+}
+
+void set_current_thread_affinity(int core) {
+    set_native_affinity(pthread_self(), core);
+}